@@ -0,0 +1,21 @@
+# main.cpp 以外のアプリ本体（ベンチマークからも取り込む）
+INCLUDEPATH += $$PWD
+
+SOURCES += \
+    $$PWD/mainwindow.cpp \
+    $$PWD/remindernotifier.cpp \
+    $$PWD/reminderpanel.cpp \
+    $$PWD/taskarchiver.cpp \
+    $$PWD/taskfilter.cpp \
+    $$PWD/tasklistmodel.cpp \
+    $$PWD/taskstore.cpp
+
+HEADERS += \
+    $$PWD/mainwindow.h \
+    $$PWD/remindernotifier.h \
+    $$PWD/reminderpanel.h \
+    $$PWD/taskarchiver.h \
+    $$PWD/taskbitmap.h \
+    $$PWD/taskfilter.h \
+    $$PWD/tasklistmodel.h \
+    $$PWD/taskstore.h
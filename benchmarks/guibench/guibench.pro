@@ -0,0 +1,15 @@
+# MainWindow の描画・操作ベンチマーク（offscreen プラットフォームで実行）
+#   qmake && make && ./guibench
+# 実行時に QT_QPA_PLATFORM が未設定なら offscreen を使う。
+
+QT       += core gui sql widgets testlib
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = guibench
+
+SOURCES += \
+    tst_guibench.cpp
+
+include(../../TODO.pri)
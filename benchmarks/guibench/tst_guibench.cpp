@@ -0,0 +1,261 @@
+#include <QtTest>
+#include <QApplication>
+#include <QComboBox>
+#include <QListView>
+#include <QScrollBar>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QTemporaryDir>
+#include <memory>
+#include "mainwindow.h"
+
+// MainWindow を offscreen で動かし、UI側のコストを件数ごとに測る。
+// 各ケースの後に QObject 数と、そのケース中のピークRSSを出力する。
+class GuiBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void firstFrame_data() { addSizes(); }
+    void firstFrame();
+    void fullRefresh_data() { addSizes(); }
+    void fullRefresh();
+    void filterChange_data() { addSizes(); }
+    void filterChange();
+    void sortChange_data() { addSizes(); }
+    void sortChange();
+    void scrollThroughAll_data() { addSizes(); }
+    void scrollThroughAll();
+    void completeRow_data() { addSizes(); }
+    void completeRow();
+
+private:
+    static void addSizes();
+    void populateDatabase(int taskCount);
+    std::unique_ptr<MainWindow> openWindow();
+    static void report(const QWidget &window);
+    static qint64 statusKb(const char *field);
+
+    QTemporaryDir workDir;
+    int populatedCount = -1;
+};
+
+void GuiBenchmark::addSizes() {
+    QTest::addColumn<int>("taskCount");
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void GuiBenchmark::initTestCase() {
+    // MainWindow はカレントディレクトリの tasks.db を開くので作業用ディレクトリへ移る
+    QVERIFY(workDir.isValid());
+    QVERIFY(QDir::setCurrent(workDir.path()));
+}
+
+// VmHWM はプロセス全体のピークなので、ケースごとに現在のRSSまでリセットする
+void GuiBenchmark::init() {
+#ifdef Q_OS_LINUX
+    QFile clearRefs("/proc/self/clear_refs");
+    if (!clearRefs.open(QIODevice::WriteOnly) || clearRefs.write("5") != 1)
+        qWarning() << "could not reset peak RSS; peakRSS is the process-wide peak";
+#endif
+}
+
+// tasks.db を taskCount 件のタスクで作り直す（同じ件数なら使い回す）
+void GuiBenchmark::populateDatabase(int taskCount) {
+    if (populatedCount == taskCount)
+        return;
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "bench");
+        db.setDatabaseName("tasks.db");
+        QVERIFY2(db.open(), qPrintable(db.lastError().text()));
+
+        QSqlQuery query(db);
+        // アプリと同じく最初から INCREMENTAL にしておく（作成後だと VACUUM が必要になる）
+        QVERIFY(query.exec("PRAGMA auto_vacuum = INCREMENTAL"));
+        QVERIFY(query.exec("CREATE TABLE IF NOT EXISTS tasks ("
+                           "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                           "taskText TEXT, "
+                           "deadline TEXT, "
+                           "tagText TEXT, "
+                           "is_completed INTEGER DEFAULT 0, "
+                           "completed_at TEXT)"));
+        QVERIFY(query.exec("DELETE FROM tasks"));
+
+        static const char *const tags[] = { "仕事", "家事", "買い物", "drink", "fruit", "snack", "仕事, 家事", "" };
+        const QDateTime now = QDateTime::currentDateTime();
+        const QString completedAt = now.toString("yyyy-MM-dd HH:mm:ss");
+
+        db.transaction();
+        query.prepare("INSERT INTO tasks (id, taskText, deadline, tagText, is_completed, completed_at) "
+                      "VALUES (?, ?, ?, ?, ?, ?)");
+        for (int i = 1; i <= taskCount; ++i) {
+            const bool completed = i % 5 == 0;
+            query.addBindValue(i);
+            query.addBindValue(QString("タスク %1").arg(i));
+            // 前後30日に散らす（約半数が期限切れ）
+            query.addBindValue(now.addSecs((i * 7919 % 86400) * 60 - 30 * 86400).toString("yyyy/MM/dd HH:mm"));
+            query.addBindValue(QString::fromUtf8(tags[i % 8]));
+            query.addBindValue(completed ? 1 : 0);
+            query.addBindValue(completed ? QVariant(completedAt) : QVariant());
+            QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+        }
+        QVERIFY(db.commit());
+    }
+    QSqlDatabase::removeDatabase("bench");
+
+    populatedCount = taskCount;
+}
+
+std::unique_ptr<MainWindow> GuiBenchmark::openWindow() {
+    auto window = std::make_unique<MainWindow>();
+    window->resize(1024, 768);
+    window->show();
+    if (!QTest::qWaitForWindowExposed(window.get()))
+        qWarning() << "window was not exposed";
+    return window;
+}
+
+void GuiBenchmark::report(const QWidget &window) {
+    qInfo().noquote() << QString("%1 [%2]: QObjects=%3 peakRSS=%4 KiB RSS=%5 KiB")
+                             .arg(QString::fromUtf8(QTest::currentTestFunction()),
+                                  QString::fromUtf8(QTest::currentDataTag()))
+                             .arg(window.findChildren<QObject *>().size() + 1)
+                             .arg(statusKb("VmHWM:"))
+                             .arg(statusKb("VmRSS:"));
+}
+
+qint64 GuiBenchmark::statusKb(const char *field) {
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        while (!status.atEnd()) {
+            const QByteArray line = status.readLine();
+            if (line.startsWith(field))
+                return line.mid(qstrlen(field)).trimmed().split(' ').value(0).toLongLong();
+        }
+    }
+#endif
+    return -1;
+}
+
+// 起動から最初の1枚を描き終えるまで
+void GuiBenchmark::firstFrame() {
+    QFETCH(int, taskCount);
+    populateDatabase(taskCount);
+
+    // 計測に含めないよう、report() と破棄はブロックの外で行う
+    std::unique_ptr<MainWindow> window;
+    QBENCHMARK_ONCE {
+        window = std::make_unique<MainWindow>();
+        window->resize(1024, 768);
+        window->show();
+        QVERIFY(QTest::qWaitForWindowExposed(window.get()));
+        window->grab();
+    }
+    report(*window);
+}
+
+// DB からの読み直しを含む一覧の再構築
+void GuiBenchmark::fullRefresh() {
+    QFETCH(int, taskCount);
+    populateDatabase(taskCount);
+    auto window = openWindow();
+    QListView *view = window->findChild<QListView *>("taskListView");
+    QVERIFY(view);
+
+    QBENCHMARK {
+        QVERIFY(QMetaObject::invokeMethod(window.get(), "updateTaskList"));
+        view->viewport()->repaint();
+    }
+    report(*window);
+}
+
+void GuiBenchmark::filterChange() {
+    QFETCH(int, taskCount);
+    populateDatabase(taskCount);
+    auto window = openWindow();
+    QComboBox *status = window->findChild<QComboBox *>("statusFilterComboBox");
+    QListView *view = window->findChild<QListView *>("taskListView");
+    QVERIFY(status && view);
+
+    int next = 0;
+    QBENCHMARK {
+        next = (next + 1) % status->count();
+        status->setCurrentIndex(next);
+        view->viewport()->repaint();
+    }
+    report(*window);
+}
+
+void GuiBenchmark::sortChange() {
+    QFETCH(int, taskCount);
+    populateDatabase(taskCount);
+    auto window = openWindow();
+    QComboBox *sort = window->findChild<QComboBox *>("sortComboBox");
+    QListView *view = window->findChild<QListView *>("taskListView");
+    QVERIFY(sort && view);
+
+    int next = 0;
+    QBENCHMARK {
+        next = (next + 1) % sort->count();
+        sort->setCurrentIndex(next);
+        view->viewport()->repaint();
+    }
+    report(*window);
+}
+
+// 先頭から末尾まで1ページずつ描画しながらスクロールする
+void GuiBenchmark::scrollThroughAll() {
+    QFETCH(int, taskCount);
+    populateDatabase(taskCount);
+    auto window = openWindow();
+    QListView *view = window->findChild<QListView *>("taskListView");
+    QVERIFY(view);
+    QScrollBar *bar = view->verticalScrollBar();
+
+    QBENCHMARK_ONCE {
+        for (int value = 0; value <= bar->maximum(); value += qMax(1, bar->pageStep())) {
+            bar->setValue(value);
+            view->viewport()->repaint();
+        }
+    }
+    report(*window);
+}
+
+// 1件を完了にして一覧へ反映されるまで
+void GuiBenchmark::completeRow() {
+    QFETCH(int, taskCount);
+    populateDatabase(taskCount);
+    auto window = openWindow();
+    QListView *view = window->findChild<QListView *>("taskListView");
+    QVERIFY(view);
+
+    int taskId = 0;
+    QBENCHMARK {
+        taskId = taskId % taskCount + 1;
+        QVERIFY(QMetaObject::invokeMethod(window.get(), "completeTask", Q_ARG(int, taskId)));
+        view->viewport()->repaint();
+    }
+    report(*window);
+
+    // 完了にした行で後続ケースの条件が変わらないよう作り直させる
+    populatedCount = -1;
+}
+
+int main(int argc, char *argv[]) {
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    GuiBenchmark benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "tst_guibench.moc"
@@ -7,6 +7,9 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QScrollArea>
+#include <QMenu>
+#include <QElapsedTimer>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), centralWidget(new QWidget(this)), mainLayout(new QVBoxLayout)
@@ -17,26 +20,104 @@ MainWindow::MainWindow(QWidget *parent)
 
     //タグフィルター
     tagFilterComboBox = new QComboBox(this);
+    tagFilterComboBox->setObjectName("tagFilterComboBox");
 
     tagFilterComboBox->addItem("すべてのタグ");  // 全件表示
     populateTagComboBox();  // タグ一覧を取得
-    connect(tagFilterComboBox, &QComboBox::currentTextChanged, this, &MainWindow::updateTaskList);
+    connect(tagFilterComboBox, &QComboBox::currentTextChanged, this, &MainWindow::applyFilter);
 
     mainLayout->addWidget(tagFilterComboBox);
 
-    // taskListLayout を初期化（1回だけ）
-    taskListLayout = new QVBoxLayout();
+    // 複合フィルタ（タグ・状態・期限・テキスト）
+    QWidget *filterArea = new QWidget(this);
+    QHBoxLayout *filterLayout = new QHBoxLayout(filterArea);
+    filterLayout->setContentsMargins(0, 0, 0, 0);
+
+    tagQueryInput = new QLineEdit(this);
+    tagQueryInput->setPlaceholderText("タグ (カンマ区切り)");
+    tagMatchComboBox = new QComboBox(this);
+    tagMatchComboBox->addItem("いずれかのタグを含む");
+    tagMatchComboBox->addItem("すべてのタグを含む");
+
+    statusFilterComboBox = new QComboBox(this);
+    statusFilterComboBox->setObjectName("statusFilterComboBox");
+    statusFilterComboBox->addItem("すべての状態");
+    statusFilterComboBox->addItem("未完了");
+    statusFilterComboBox->addItem("完了済み");
+
+    overdueCheckBox = new QCheckBox("期限切れのみ", this);
+
+    deadlineRangeCheckBox = new QCheckBox("期限:", this);
+    deadlineFromInput = new QDateTimeEdit(QDateTime(QDate::currentDate(), QTime(0, 0)), this);
+    deadlineToInput = new QDateTimeEdit(QDateTime(QDate::currentDate().addDays(7), QTime(23, 59)), this);
+    deadlineFromInput->setCalendarPopup(true);
+    deadlineToInput->setCalendarPopup(true);
+    deadlineFromInput->setEnabled(false);
+    deadlineToInput->setEnabled(false);
+
+    textFilterInput = new QLineEdit(this);
+    textFilterInput->setObjectName("textFilterInput");
+    textFilterInput->setPlaceholderText("タスク名で検索");
+
+    filterLayout->addWidget(tagQueryInput);
+    filterLayout->addWidget(tagMatchComboBox);
+    filterLayout->addWidget(statusFilterComboBox);
+    filterLayout->addWidget(overdueCheckBox);
+    filterLayout->addWidget(deadlineRangeCheckBox);
+    filterLayout->addWidget(deadlineFromInput);
+    filterLayout->addWidget(new QLabel("〜", this));
+    filterLayout->addWidget(deadlineToInput);
+    filterLayout->addWidget(textFilterInput);
+    mainLayout->addWidget(filterArea);
+
+    connect(tagQueryInput, &QLineEdit::textChanged, this, &MainWindow::applyFilter);
+    connect(tagMatchComboBox, &QComboBox::currentIndexChanged, this, &MainWindow::applyFilter);
+    connect(statusFilterComboBox, &QComboBox::currentIndexChanged, this, &MainWindow::applyFilter);
+    connect(overdueCheckBox, &QCheckBox::toggled, this, &MainWindow::applyFilter);
+    connect(deadlineRangeCheckBox, &QCheckBox::toggled, deadlineFromInput, &QWidget::setEnabled);
+    connect(deadlineRangeCheckBox, &QCheckBox::toggled, deadlineToInput, &QWidget::setEnabled);
+    connect(deadlineRangeCheckBox, &QCheckBox::toggled, this, &MainWindow::applyFilter);
+    connect(deadlineFromInput, &QDateTimeEdit::dateTimeChanged, this, &MainWindow::applyFilter);
+    connect(deadlineToInput, &QDateTimeEdit::dateTimeChanged, this, &MainWindow::applyFilter);
+    connect(textFilterInput, &QLineEdit::textChanged, this, &MainWindow::applyFilter);
+
+    // タスク一覧のモデル（ビューは入力エリアの下に配置）
+    taskListModel = new TaskListModel(&taskStore, this);
+
+    // 表示中の行の色はモデルが期限の時刻に合わせて更新する。
+    // 期限切れで絞り込んでいる時だけ、新たに条件を満たした行をその位置に挿入する
+    connect(taskListModel, &TaskListModel::hiddenTasksBecameOverdue, this, [this](const QVector<int> &tasks) {
+        if (!overdueCheckBox->isChecked()) {
+            return;
+        }
+        const TaskFilter filter = currentFilter();
+        const QDateTime now = QDateTime::currentDateTime();
+        QVector<int> matched;
+        for (int i : tasks) {
+            if (filter.matches(taskStore, i, now)) {
+                matched.append(i);
+            }
+        }
+        taskListModel->insertTasks(matched, sortKey);
+    });
 
     // 並び替え用のコンボボックスを追加
     QComboBox *sortComboBox = new QComboBox(this);
+    sortComboBox->setObjectName("sortComboBox");
     sortComboBox->addItem("タスク名で並び替え");
     sortComboBox->addItem("締切日で並び替え");
     sortComboBox->addItem("タグで並び替え");
+    sortComboBox->setCurrentIndex(1);  // 初期の並び順（sortKey）は締切日
     mainLayout->addWidget(sortComboBox);
 
     // 並び替えの選択変更を接続
     connect(sortComboBox, &QComboBox::currentTextChanged, this, &MainWindow::sortTaskList);
 
+    // アーカイブ検索
+    QPushButton *archiveSearchButton = new QPushButton("アーカイブを検索", this);
+    mainLayout->addWidget(archiveSearchButton);
+    connect(archiveSearchButton, &QPushButton::clicked, this, &MainWindow::showArchiveSearch);
+
     // データベースの初期化
     initializeDatabase();
     // 🔄 アプリ起動時にタスク一覧を更新
@@ -44,21 +125,18 @@ MainWindow::MainWindow(QWidget *parent)
     setupTaskTable();
     tableView->setVisible(false);
 
-
-
-    QSqlQuery query;
-    query.exec("ALTER TABLE tasks ADD COLUMN is_completed INTEGER DEFAULT 0;");
-
-    while (query.next()) {
-        QString taskName = query.value(1).toString();  // タスク名
-        QString taskDeadline = query.value(2).toString();  // 締切
-        QString taskTag = query.value(3).toString();  // タグ
-        QLabel *taskLabel = new QLabel(taskName + " (" + taskTag + " - " + taskDeadline + ")", this);
-
-        QDateTime deadlineDateTime = QDateTime::fromString(taskDeadline, "yyyy-MM-dd HH:mm:ss");
-        if (deadlineDateTime < QDateTime::currentDateTime())  {
-            taskLabel->setStyleSheet("color: red; font-weight: bold;");
-        }
+    // 完了から30日経ったタスクをアーカイブへ移す（起動直後は避け、以降は1時間ごと）
+    taskArchiver = new TaskArchiver(this);
+    if (taskArchiver->attachArchive()) {
+        connect(taskArchiver, &TaskArchiver::finished, this, [this](int archivedCount) {
+            if (archivedCount > 0) {
+                updateTaskList();
+            }
+        });
+        archiveTimer = new QTimer(this);
+        connect(archiveTimer, &QTimer::timeout, taskArchiver, &TaskArchiver::start);
+        archiveTimer->start(60 * 60 * 1000);
+        QTimer::singleShot(5000, taskArchiver, &TaskArchiver::start);
     }
 
     // +ボタン
@@ -86,17 +164,25 @@ MainWindow::MainWindow(QWidget *parent)
     mainLayout->addWidget(taskInputArea);
     connect(addTaskButton, &QPushButton::clicked, this, &MainWindow::addTask);
 
-    // taskListLayout を初期化した後、QScrollArea を作成
-    QWidget *container = new QWidget();
-    container->setLayout(taskListLayout);
-    QScrollArea *scrollArea = new QScrollArea(this);
-    scrollArea->setWidget(container);
-    scrollArea->setWidgetResizable(true);
+    // タスク一覧（行ごとにウィジェットを作らずモデルで表示）
+    taskListView = new QListView(this);
+    taskListView->setObjectName("taskListView");
+    taskListView->setModel(taskListModel);
+    taskListView->setUniformItemSizes(true);
+    taskListView->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(taskListView, &QListView::customContextMenuRequested, this, &MainWindow::showTaskContextMenu);
+    connect(taskListView, &QListView::doubleClicked, this, [this](const QModelIndex &index) {
+        int i = taskListModel->storeIndex(index.row());
+        if (i < 0)
+            return;
+        editTask(taskStore.ids[i], taskStore.names[i], taskStore.tagTexts[i],
+                 taskStore.deadlineAt(i).toString(Qt::ISODate));
+    });
 
-    // mainLayout に scrollArea を追加
-    mainLayout->addWidget(scrollArea);
+    mainLayout->addWidget(taskListView);
 
     // リマインダー用のタイマー
+    reminderNotifier = new ReminderNotifier(this);
     reminderTimer = new QTimer(this);
     connect(reminderTimer, &QTimer::timeout, this, &MainWindow::checkReminders);
     reminderTimer->start(60000); // 1分ごとにチェック
@@ -137,94 +223,21 @@ void MainWindow::showInputFields() {
 }
 
 void MainWindow::addTask() {
-    QSqlQuery query;
-
     QString taskText = taskInput->text().trimmed();
     QString tagText = tagInput->text().trimmed();
     QDateTime deadline = deadlineInput->dateTime();
 
-    while (query.next()) {
-        int taskId = query.value(0).toInt();  // タスクID
-        QString taskName = query.value(1).toString();  // タスク名
-        QString taskDeadline = query.value(2).toString();  // 締切
-        QString taskTag = query.value(3).toString();  // タグ
-
-
-
-        QLabel *taskLabel = new QLabel(taskName + " (" + taskTag + " - " + taskDeadline + ")", this);
-        QDateTime deadlineDateTime = QDateTime::fromString(taskDeadline, "yyyy-MM-dd HH:mm:ss");
-        if (deadlineDateTime < QDateTime::currentDateTime())  {
-            taskLabel->setStyleSheet("color: red; font-weight: bold;");
-        }
-        QPushButton *editTaskButton = new QPushButton("編集", this);
-
-        connect(editTaskButton, &QPushButton::clicked, this, [this, taskId, taskName, taskTag, taskDeadline]() {
-            editTask(taskId, taskName, taskTag, taskDeadline);
-        });
-
-        QHBoxLayout *taskLayout = new QHBoxLayout();
-        taskLayout->addWidget(taskLabel);
-        taskLayout->addWidget(editTaskButton);
-
-        QWidget *taskWidget = new QWidget();
-        taskWidget->setLayout(taskLayout);
-        taskListLayout->addWidget(taskWidget);
-    }
-
     if (!taskText.isEmpty()) {
-        int taskId = query.value(0).toInt();  // タスクID
-        QString taskName = query.value(1).toString();  // タスク名
-        QString taskDeadline = query.value(2).toString();  // 締切
-        QString taskTag = query.value(3).toString();  //タグ
         saveTaskToDatabase(taskText, deadline, tagText); // データベースに保存
 
         qDebug() << "タスク追加:" << taskText << deadline.toString("yyyy/MM/dd HH:mm") << tagText;
 
-
-        // **新しいタスクをその場でリストに追加**
-        QWidget *taskRow = new QWidget(this);
-        QHBoxLayout *taskLayout = new QHBoxLayout(taskRow);
-
-        QLabel *taskLabel = new QLabel(taskText + " (期限: " + deadline.toString("yyyy/MM/dd HH:mm") + ")", this);
-        QLabel *tagLabel = new QLabel(tagText.isEmpty() ? "なし" : tagText, this);
-        tagLabel->setStyleSheet("color: #888; font-size: 12px;");
-
-        QPushButton *editTaskButton = new QPushButton("変更", this);
-        QPushButton *deleteTaskButton = new QPushButton("削除", this);
-        QPushButton *completeTaskButton = new QPushButton("完了", this);
-
-        taskLayout->addWidget(taskLabel);
-        taskLayout->addWidget(tagLabel);
-        taskLayout->addWidget(editTaskButton);
-        taskLayout->addWidget(deleteTaskButton);
-        taskLayout->addWidget(completeTaskButton);
-        taskRow->setLayout(taskLayout);
-
-        taskListLayout->addWidget(taskRow);
-
-        connect(editTaskButton, &QPushButton::clicked, this, [this, taskId, taskName, taskTag, taskDeadline]() {
-            editTask(taskId, taskName, taskTag, taskDeadline);
-        });
-
-
-        connect(deleteTaskButton, &QPushButton::clicked, [this, taskId,taskRow]() {
-            deleteTask(taskId);   // taskRow ではなく taskId を渡す
-            taskRow->deleteLater();  // UIから削除
-        });
-
-        connect(completeTaskButton, &QPushButton::clicked, [this, taskId,taskRow]() {
-            completeTask(taskId);   // taskRow ではなく taskId を渡す
-        });
-
         // 新しいタスクを追加後、リストを更新
         updateTaskList();
 
         taskInput->clear();
         tagInput->clear();
     }
-
-
-
 }
 
 // **変更ボタンの処理**
@@ -303,10 +316,55 @@ void MainWindow::deleteTask(int taskId) {
     }
 }
 
+// **アーカイブ検索**
+void MainWindow::showArchiveSearch() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("アーカイブ検索");
+
+    QVBoxLayout layout(&dialog);
+
+    QLineEdit searchInput;
+    searchInput.setPlaceholderText("タスク名・タグで検索");
+    QSqlQueryModel archiveModel;
+    QTableView archiveView;
+    archiveView.setModel(&archiveModel);
+
+    layout.addWidget(&searchInput);
+    layout.addWidget(&archiveView);
+
+    // 入力のたびに必要な分だけ問い合わせる
+    auto search = [&]() {
+        QSqlQuery query;
+        query.prepare("SELECT taskText, tagText, deadline, completed_at, archived_at "
+                      "FROM archive.tasks_archive "
+                      "WHERE taskText LIKE :text OR tagText LIKE :tag "
+                      "ORDER BY completed_at DESC LIMIT 500");
+        QString pattern = "%" + searchInput.text().trimmed() + "%";
+        query.bindValue(":text", pattern);
+        query.bindValue(":tag", pattern);
+        if (!query.exec()) {
+            qDebug() << "アーカイブ検索エラー:" << query.lastError().text();
+            return;
+        }
+        archiveModel.setQuery(std::move(query));
+        archiveModel.setHeaderData(0, Qt::Horizontal, "タスク");
+        archiveModel.setHeaderData(1, Qt::Horizontal, "タグ");
+        archiveModel.setHeaderData(2, Qt::Horizontal, "期限");
+        archiveModel.setHeaderData(3, Qt::Horizontal, "完了日時");
+        archiveModel.setHeaderData(4, Qt::Horizontal, "アーカイブ日時");
+    };
+    connect(&searchInput, &QLineEdit::textChanged, &dialog, search);
+    search();
+
+    dialog.resize(640, 400);
+    dialog.exec();
+}
+
 // **完了ボタンの処理**
 void MainWindow::completeTask(int taskId) {
     QSqlQuery query;
-    query.prepare("UPDATE tasks SET is_completed = 1 WHERE id = :id");
+    query.prepare("UPDATE tasks SET is_completed = 1, completed_at = :completedAt WHERE id = :id");
+    query.bindValue(":completedAt", QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
     query.bindValue(":id", taskId);
 
     if (!query.exec()) {
@@ -319,15 +377,69 @@ void MainWindow::completeTask(int taskId) {
     updateTaskList();  // UI を更新
 }
 
+// **未完了に戻す処理**
+void MainWindow::reopenTask(int taskId) {
+    QSqlQuery query;
+    query.prepare("UPDATE tasks SET is_completed = 0, completed_at = NULL WHERE id = :id");
+    query.bindValue(":id", taskId);
+
+    if (!query.exec()) {
+        qDebug() << "タスクを未完了に戻せませんでした:" << query.lastError().text();
+        return;
+    }
 
+    qDebug() << "タスクを未完了に戻しました: ID =" << taskId;
+
+    updateTaskList();
+}
+
+
+// 期限が1分以内のタスクをまとめて通知に渡す（表示は ReminderNotifier が非モーダルで行う）
 void MainWindow::checkReminders() {
     QDateTime now = QDateTime::currentDateTime();
+    const qint64 to = now.addSecs(60).toMSecsSinceEpoch();
+
+    // タイマーはずれるので、前回の実行時刻から見る（初回や時計が戻ったときは今から）。
+    // 前回見た範囲と重なるが、その間に追加・編集されたタスクも拾える。重複は (ID, 期限) で除かれる
+    qint64 from = now.toMSecsSinceEpoch();
+    if (lastReminderCheck > 0 && lastReminderCheck < from)
+        from = lastReminderCheck;
+    lastReminderCheck = now.toMSecsSinceEpoch();
+
+    // 締切順の並びから該当範囲だけを二分探索で取り出す
+    const QVector<int> &byDeadline = taskStore.order(TaskStore::SortByDeadline);
+    auto first = std::upper_bound(byDeadline.begin(), byDeadline.end(), from, [this](qint64 value, int i) {
+        return value < taskStore.deadlines[i];
+    });
 
-    for (const auto &task : taskList) {
-        if (task.deadline <= now.addSecs(60)) {  // 期限が1分以内
-            QMessageBox::warning(this, "リマインダー", "タスク期限が近づいています: " + task.taskLabel->text());
+    QList<Reminder> due;
+    for (auto it = first; it != byDeadline.end() && taskStore.deadlines[*it] <= to; ++it) {
+        if (!taskStore.isCompleted(*it)) {
+            due.append({taskStore.ids[*it], taskStore.names[*it], taskStore.deadlineAt(*it)});
         }
     }
+
+    reminderNotifier->post(due, now, [this](const Reminder &reminder) {
+        return isTaskOpenWithDeadline(reminder.taskId, reminder.deadline);
+    });
+}
+
+// 同じ期限のタスクだけを締切順の並びから二分探索で調べる
+bool MainWindow::isTaskOpenWithDeadline(int taskId, const QDateTime &deadline) const {
+    const qint64 msecs = deadline.isValid() ? deadline.toMSecsSinceEpoch() : TaskStore::NoDeadline;
+    struct DeadlineLess {
+        const TaskStore *store;
+        bool operator()(int i, qint64 value) const { return store->deadlines[i] < value; }
+        bool operator()(qint64 value, int i) const { return value < store->deadlines[i]; }
+    };
+
+    const QVector<int> &byDeadline = taskStore.order(TaskStore::SortByDeadline);
+    auto range = std::equal_range(byDeadline.begin(), byDeadline.end(), msecs, DeadlineLess{&taskStore});
+    for (auto it = range.first; it != range.second; ++it) {
+        if (taskStore.ids[*it] == taskId)
+            return !taskStore.isCompleted(*it);
+    }
+    return false;
 }
 
 void MainWindow::initializeDatabase() {
@@ -346,11 +458,42 @@ void MainWindow::initializeDatabase() {
     }
 
     QSqlQuery query;
+
+    // 削除・アーカイブで空いたページを少しずつ返せるようにする。
+    // 新しいDBはテーブル作成前に設定するだけで効くが、既存DBは VACUUM でファイルを作り直さないと切り替わらない。
+    // VACUUM は実行中の文があると失敗するので、モデルやクエリを開く前のここで一度だけ行う。
+    // ファイル全体を書き直すため時間はDBの大きさに比例する（初回起動時のみ。所要時間はログに出す）
+    if (query.exec("PRAGMA auto_vacuum") && query.next() && query.value(0).toInt() != 2) {
+        query.finish();
+        query.exec("PRAGMA auto_vacuum = INCREMENTAL");
+        if (query.exec("PRAGMA page_count") && query.next() && query.value(0).toInt() > 0) {
+            query.finish();
+            QElapsedTimer timer;
+            timer.start();
+            if (query.exec("VACUUM")) {
+                qDebug() << "auto_vacuum を INCREMENTAL に切り替えました:" << timer.elapsed() << "ms";
+            } else {
+                qDebug() << "VACUUM に失敗しました:" << query.lastError().text();
+            }
+        }
+    }
+    query.finish();
+
     query.exec("CREATE TABLE IF NOT EXISTS tasks ("
                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
                "taskText TEXT, "
                "deadline TEXT, "
                "tagText TEXT)");
+    query.exec("ALTER TABLE tasks ADD COLUMN is_completed INTEGER DEFAULT 0;");  // 既存DB向け（既にあれば失敗するだけ）
+    query.exec("ALTER TABLE tasks ADD COLUMN completed_at TEXT;");
+
+    // 完了日時を記録する前に完了したタスクは、今完了したものとして扱う（30日後にアーカイブされる）
+    query.prepare("UPDATE tasks SET completed_at = :now WHERE is_completed = 1 AND completed_at IS NULL");
+    query.bindValue(":now", QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+    if (!query.exec()) {
+        qDebug() << "完了日時の補完に失敗しました:" << query.lastError().text();
+    }
+    query.exec("CREATE INDEX IF NOT EXISTS idx_tasks_completed ON tasks (is_completed, completed_at)");
 
     qDebug() << "Database initialized successfully.";
 }
@@ -379,107 +522,72 @@ void MainWindow::saveTaskToDatabase(const QString &taskText, const QDateTime &de
     }
 }
 
+// DB から列データを読み直してフィルタを再適用する
 void MainWindow::updateTaskList() {
+    loadTasksFromDatabase();
+    applyFilter();
+}
 
-    // 🔹 tagFilterComboBox の nullptr チェック
-    if (!tagFilterComboBox) {
-        qDebug() << "tagFilterComboBox が nullptr です";
-        return;
-    }
+TaskFilter MainWindow::currentFilter() const {
+    TaskFilter filter;
 
     QString selectedTag = tagFilterComboBox->currentText();
-
-    QString queryStr = "SELECT * FROM tasks";
-    QSqlQuery query;
-
     if (selectedTag != "すべてのタグ" && !selectedTag.isEmpty()) {
-        queryStr += " WHERE tagText = :tag";
-        query.prepare(queryStr);
-        query.bindValue(":tag", selectedTag);
-    } else {
-        query.prepare(queryStr);
+        filter.requiredTag = selectedTag;
     }
+    filter.tags += TaskStore::splitTags(tagQueryInput->text());
+    filter.tagMatch = tagMatchComboBox->currentIndex() == 1 ? TaskFilter::MatchAllTags
+                                                            : TaskFilter::MatchAnyTag;
 
-    if (!query.exec()) {
-        qDebug() << "クエリの実行に失敗しました:" << query.lastError().text();
-        return;
-    }
+    filter.status = static_cast<TaskFilter::Status>(statusFilterComboBox->currentIndex());
+    filter.overdueOnly = overdueCheckBox->isChecked();
 
-    // 🔹 クエリにデータがあるか確認
-    if (!query.next()) {
-        qDebug() << "タスクがデータベースに存在しません。";
-        return;
+    if (deadlineRangeCheckBox->isChecked()) {
+        filter.deadlineFrom = deadlineFromInput->dateTime();
+        filter.deadlineTo = deadlineToInput->dateTime();
     }
-    query.previous();  // 最初のレコードに戻す
 
-    // 🔹 過去のリストをクリア
-    while (QLayoutItem *child = taskListLayout->takeAt(0)) {
-        if (child->widget()) {
-            qDebug() << "削除: " << child->widget()->objectName();  // 確認用ログ
+    filter.text = textFilterInput->text();
+    return filter;
+}
 
-            child->widget()->deleteLater();
-        }
-        delete child;
-    }
+void MainWindow::applyFilter() {
+    QElapsedTimer timer;
+    timer.start();
 
-    while (query.next()) {
-        int taskId = query.value("id").toInt();
-        QString taskName = query.value("taskText").toString();
-        QString taskTag = query.value("tagText").toString();
-        QDateTime taskDeadline = query.value("deadline").toDateTime();
-        bool isCompleted = query.value("is_completed").toBool();
-        QString deadlineStr = taskDeadline.toString("yyyy-MM-dd HH:mm");
-
-        qDebug() << "取得したタスク: " << taskName << " (" << taskTag << "), 期限: " << deadlineStr;
-
-        QLabel *taskLabel = new QLabel(taskName + " (" + taskTag + ") 期限: " + deadlineStr, this);
-        QPushButton *editButton = new QPushButton("編集");
-        QPushButton *deleteButton = new QPushButton("削除");
-        QPushButton *completeButton = new QPushButton("完了", this);
-
-        if (taskDeadline < QDateTime::currentDateTime()) {
-            taskLabel->setStyleSheet("color: red; font-weight: bold;");
-        }
+    QDateTime now = QDateTime::currentDateTime();
+    TaskBitmap matches = currentFilter().evaluate(taskStore, now);
+    taskListModel->setRows(TaskFilter::collect(taskStore, matches, sortKey), now);
 
-        QWidget *taskRow = new QWidget(this);
-        QHBoxLayout *taskLayout = new QHBoxLayout(taskRow);
-        taskLayout->addWidget(taskLabel);
-        taskLayout->addWidget(editButton);
-        taskLayout->addWidget(deleteButton);
-        taskLayout->addWidget(completeButton);
-        taskRow->setLayout(taskLayout);
+    qDebug() << "applyFilter():" << taskListModel->rowCount() << "/" << taskStore.size()
+             << "件," << timer.elapsed() << "ms";
+}
 
-        taskListLayout->addWidget(taskRow);
+void MainWindow::showTaskContextMenu(const QPoint &pos) {
+    int i = taskListModel->storeIndex(taskListView->indexAt(pos).row());
+    if (i < 0)
+        return;
 
-        // 🔹 完了済みタスクの処理
-        if (isCompleted) {
-            taskLabel->setStyleSheet("color: gray; text-decoration: line-through;");
-            completeButton->setEnabled(false);
+    int taskId = taskStore.ids[i];
+    QMenu menu(this);
+    QAction *editAction = menu.addAction("編集");
+    QAction *completeAction = taskStore.isCompleted(i) ? menu.addAction("未完了に戻す")
+                                                       : menu.addAction("完了");
+    QAction *deleteAction = menu.addAction("削除");
+
+    QAction *chosen = menu.exec(taskListView->viewport()->mapToGlobal(pos));
+    if (chosen == editAction) {
+        editTask(taskId, taskStore.names[i], taskStore.tagTexts[i],
+                 taskStore.deadlineAt(i).toString(Qt::ISODate));
+    } else if (chosen == completeAction) {
+        if (taskStore.isCompleted(i)) {
+            reopenTask(taskId);
+        } else {
+            completeTask(taskId);
         }
-
-        // 🔹 削除ボタンの動作
-        connect(deleteButton, &QPushButton::clicked, this, [this, taskId]() {
-            deleteTask(taskId);
-        });
-
-        // 🔹 編集ボタンの動作
-        connect(editButton, &QPushButton::clicked, this, [this, taskId, taskName, taskTag, deadlineStr]() {
-            editTask(taskId, taskName, taskTag, deadlineStr);
-        });
-
-        // 🔹 完了ボタンの動作
-        connect(completeButton, &QPushButton::clicked, this, [this, taskId]() {
-            QSqlQuery query;
-            query.prepare("UPDATE tasks SET is_completed = 1 WHERE id = :id");
-            query.bindValue(":id", taskId);
-            if (!query.exec()) {
-                qDebug() << "タスクの完了に失敗しました:" << query.lastError().text();
-            }
-            updateTaskList();
-        });
+    } else if (chosen == deleteAction) {
+        deleteTask(taskId);
     }
-
-    qDebug() << "updateTaskList() 完了";
 }
 
 void MainWindow::populateTagComboBox()
@@ -516,84 +624,16 @@ void MainWindow::setupTaskTable()
 
 void MainWindow::sortTaskList(const QString &sortOption)
 {
-    // 並び替え基準を決定
+    // 並び替え基準を決定（並び順は TaskStore が保持しているので DB は読み直さない）
     if (sortOption == "タスク名で並び替え") {
-        model->setSort(1, Qt::AscendingOrder);  // taskText（1番目のカラム）
+        sortKey = TaskStore::SortByName;
     } else if (sortOption == "締切日で並び替え") {
-        model->setSort(2, Qt::AscendingOrder);  // deadline（2番目のカラム）
+        sortKey = TaskStore::SortByDeadline;
     } else if (sortOption == "タグで並び替え") {
-        model->setSort(3, Qt::AscendingOrder);  // tagText（3番目のカラム）
+        sortKey = TaskStore::SortByTag;
     }
 
-    model->select(); // データを取得し直す
-
-    // **リストをクリア**
-    while (QLayoutItem *child = taskListLayout->takeAt(0)) {
-        if (child->widget()) {
-            child->widget()->deleteLater();
-        }
-        delete child;
-    }
-    QSqlQuery query;
-    query.exec("SELECT DISTINCT tag FROM tasks");
-
-    // **並び替え後のデータを取得してリストを再描画**
-
-    for (int row = 0; row < model->rowCount(); ++row) {
-        int taskId = model->index(row, 0).data().toInt();  // id (0番目のカラム)
-        QString taskName = model->index(row, 1).data().toString();  // taskText
-        QString taskDeadline = model->index(row, 2).data().toString();  // deadline
-        QString taskTag = model->index(row, 3).data().toString();  // tagText
-        bool isCompleted = model->index(row, 4).data().toBool(); // 完了状態を取得
-
-        QLabel *taskLabel = new QLabel(taskName + " (" + taskTag + " - " + taskDeadline + ")", this);
-
-
-        // 完了しているタスクにはスタイルを適用
-        if (isCompleted) {
-            taskLabel->setStyleSheet("color: grey; text-decoration: line-through;");
-        }
-        // 締切日が過ぎている場合は赤色で太字に
-        QDateTime deadlineDateTime = QDateTime::fromString(taskDeadline, "yyyy-MM-dd HH:mm");
-        if (deadlineDateTime < QDateTime::currentDateTime()) {
-            taskLabel->setStyleSheet("color: red; font-weight: bold;");
-        }
-        // 完了ボタンを作成
-        QPushButton *completeButton = new QPushButton(isCompleted ? "未完了" : "完了", this);
-        connect(completeButton, &QPushButton::clicked, this, [this, taskId, isCompleted]() {
-            QSqlQuery query;
-            query.prepare("UPDATE tasks SET is_completed = :isCompleted WHERE id = :id");
-            query.bindValue(":id", taskId);
-            query.bindValue(":isCompleted", !isCompleted);  // 完了状態を切り替え
-            if (!query.exec()) {
-                qDebug() << "タスクの完了に失敗しました:" << query.lastError().text();
-            }
-            updateTaskList();
-        });
-
-        // 削除ボタンを作成
-        QPushButton *deleteButton = new QPushButton("削除", this);
-        connect(deleteButton, &QPushButton::clicked, this, [this, taskId]() {
-            deleteTask(taskId);
-        });
-
-        // 変更ボタンを作成
-        QPushButton *editButton = new QPushButton("変更", this);
-        connect(editButton, &QPushButton::clicked, this, [this, taskId, taskName, taskTag, taskDeadline]() {
-            editTask(taskId, taskName, taskTag, taskDeadline);
-        });
-
-        // タスクラベルとボタンをレイアウトに追加
-        QHBoxLayout *taskLayout = new QHBoxLayout();
-        taskLayout->addWidget(taskLabel);
-        taskLayout->addWidget(completeButton);
-        taskLayout->addWidget(deleteButton);
-        taskLayout->addWidget(editButton);
-        QWidget *taskWidget = new QWidget(this);
-        taskWidget->setLayout(taskLayout);
-        taskListLayout->addWidget(taskWidget);  // 新しい順序でリストを作成
-
-    }
+    applyFilter();
 
     // QTableViewが表示されていないかを確認
     if (tableView) {
@@ -601,65 +641,10 @@ void MainWindow::sortTaskList(const QString &sortOption)
     }
 }
 
-
-
-
 void MainWindow::loadTasksFromDatabase() {
-    QSqlDatabase db = QSqlDatabase::database();
-    if (!db.isOpen()) {
-        qDebug() << "Database is not open!";
+    if (!taskStore.loadFromDatabase()) {
         return;
     }
 
-    QSqlQuery query;
-    if (!query.exec("SELECT id, taskText, tagText, deadline FROM tasks")) {
-        qDebug() << "Failed to load tasks:" << query.lastError().text();
-        return;
-    }
-
-    while (query.next()) {
-        int id = query.value(0).toInt();
-        QString taskText = query.value(1).toString();
-        QString tagText = query.value(2).toString();
-        QDateTime deadline = query.value(3).toDateTime();
-
-
-        QWidget *taskRow = new QWidget(this);
-        QHBoxLayout *taskLayout = new QHBoxLayout(taskRow);
-
-        QLabel *taskLabel = new QLabel(taskText + " (期限: " + deadline.toString("yyyy/MM/dd HH:mm") + ")", this);
-        QLabel *tagLabel = new QLabel(tagText.isEmpty() ? "なし" : tagText, this);
-
-        tagLabel->setStyleSheet("color: #888; font-size: 12px;");
-
-        QPushButton *editTaskButton = new QPushButton("変更", this);
-        QPushButton *deleteTaskButton = new QPushButton("削除", this);
-
-        taskLayout->addWidget(taskLabel);
-        taskLayout->addWidget(tagLabel);
-        taskLayout->addWidget(editTaskButton);
-        taskLayout->addWidget(deleteTaskButton);
-        taskRow->setLayout(taskLayout);
-
-        taskListLayout->addWidget(taskRow);
-        taskList.append(Task(taskLabel, deadline, tagText));
-        taskRow->update();
-        update();  // 🔴 UIの更新を試す
-
-        // 編集・削除ボタンの処理
-        QString deadlineStr = deadline.toString("yyyy-MM-dd HH:mm:ss");  // QDateTime → QString に変換
-
-        connect(editTaskButton, &QPushButton::clicked, this, [this,id, taskText, tagText, deadlineStr]() {
-            editTask(id, taskText, tagText, deadlineStr);
-        });
-
-        connect(deleteTaskButton, &QPushButton::clicked, this, [this, id]() {
-            deleteTask(id);
-        });
-    }
-
-
-
-    query.finish();
     qDebug() << "Finished loading tasks.";
 }
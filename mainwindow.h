@@ -15,22 +15,20 @@
 #include <QScrollArea>
 #include <QComboBox>
 #include <QSqlTableModel>
+#include <QSqlQueryModel>
 #include <QTableView>
+#include <QListView>
+#include <QCheckBox>
+#include "taskstore.h"
+#include "taskfilter.h"
+#include "tasklistmodel.h"
+#include "remindernotifier.h"
+#include "taskarchiver.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
-class Task {
-public:
-    Task(QLabel *label, const QDateTime &dt, const QString &tag)  // 引数をconst参照に変更
-        : taskLabel(label), deadline(dt), tagText(tag) {}
-
-    QLabel *taskLabel;
-    QDateTime deadline;
-    QString tagText;
-};
-
 class MainWindow : public QMainWindow
 {
     Q_OBJECT
@@ -50,11 +48,18 @@ private slots:
     void updateTaskList();
     void loadTasksFromDatabase();
     void completeTask(int taskId);
+    void reopenTask(int taskId);
     void populateTagComboBox();
     void setupTaskTable();
     void sortTaskList(const QString &sortOption);
+    void applyFilter();       // フィルタ条件を変えたときは DB を読み直さずに再評価
+    void showTaskContextMenu(const QPoint &pos);
+    void showArchiveSearch();  // アーカイブ済みタスクの検索
 
 private:
+    TaskFilter currentFilter() const;
+    bool isTaskOpenWithDeadline(int taskId, const QDateTime &deadline) const;
+
     QWidget *centralWidget;
     QVBoxLayout *mainLayout;
     QDateTimeEdit *deadlineInput; // 期限入力用
@@ -66,15 +71,31 @@ private:
 
     QPushButton *addTaskButton;
     QTimer *reminderTimer; // ⏳ リマインダー用タイマー
+    ReminderNotifier *reminderNotifier;
+    qint64 lastReminderCheck = 0;  // 前回 checkReminders() を実行した時刻
+    TaskArchiver *taskArchiver;
+    QTimer *archiveTimer;
 
-
-    QVBoxLayout *taskListLayout;
-    QList<Task> taskList;  // タスクリストをTask型に変更
     QComboBox *tagFilterComboBox;
     QComboBox *sortComboBox ;
     QSqlTableModel *model;
     QTableView *tableView;
 
+    // 複合フィルタ
+    QLineEdit *tagQueryInput;       // カンマ区切りの複数タグ
+    QComboBox *tagMatchComboBox;    // いずれか / すべて
+    QComboBox *statusFilterComboBox;
+    QCheckBox *overdueCheckBox;
+    QCheckBox *deadlineRangeCheckBox;
+    QDateTimeEdit *deadlineFromInput;
+    QDateTimeEdit *deadlineToInput;
+    QLineEdit *textFilterInput;
+
+    TaskStore taskStore;            // tasks テーブルの列データ
+    TaskStore::SortKey sortKey = TaskStore::SortByDeadline;
+    TaskListModel *taskListModel;
+    QListView *taskListView;
+
 
 };
 
@@ -0,0 +1,136 @@
+#include "remindernotifier.h"
+#include <QStyle>
+#include <QDebug>
+#include <algorithm>
+
+ReminderNotifier::ReminderNotifier(QWidget *window)
+    : QObject(window), flushTimer(new QTimer(this)), panel(new ReminderPanel(window))
+{
+    flushTimer->setSingleShot(true);
+    connect(flushTimer, &QTimer::timeout, this, &ReminderNotifier::flush);
+
+    connect(panel, &ReminderPanel::snoozeRequested, this, &ReminderNotifier::snooze);
+    connect(panel, &ReminderPanel::dismissRequested, this, &ReminderNotifier::dismiss);
+
+    // トレイが使える環境ではトレイにも要約を出す
+    if (QSystemTrayIcon::isSystemTrayAvailable()) {
+        trayIcon = new QSystemTrayIcon(window->style()->standardIcon(QStyle::SP_MessageBoxWarning), this);
+        trayIcon->setToolTip("TODO リマインダー");
+        connect(trayIcon, &QSystemTrayIcon::messageClicked, this, &ReminderNotifier::showPanel);
+        connect(trayIcon, &QSystemTrayIcon::activated, this, &ReminderNotifier::showPanel);
+        trayIcon->show();
+    }
+}
+
+void ReminderNotifier::post(const QList<Reminder> &due, const QDateTime &now,
+                            const std::function<bool(const Reminder &)> &stillDue) {
+    for (const Reminder &reminder : due) {
+        // 期限が編集されたタスクは別の通知として扱う
+        auto it = notified.constFind(reminder.taskId);
+        if (it != notified.constEnd() && it.value() == reminder.deadline)
+            continue;
+        notified.insert(reminder.taskId, reminder.deadline);
+        pending.insert(reminder.taskId, reminder);
+    }
+
+    pruneNotified(now, stillDue);
+
+    // スヌーズが明けたものを戻す（その間に完了・削除・期限変更されたものは捨てる）
+    for (auto it = snoozedUntil.begin(); it != snoozedUntil.end();) {
+        if (it.value() <= now) {
+            Reminder reminder = snoozed.take(it.key());
+            if (stillDue(reminder) && !pending.contains(reminder.taskId))
+                pending.insert(reminder.taskId, reminder);
+            it = snoozedUntil.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!pending.isEmpty())
+        scheduleFlush();
+}
+
+// 通知済みの記録は重複排除のためだけにあるので、もう走査範囲に入らないものは捨てる。
+// 期限が now より前のもの（次回は now から見る）と、完了・削除・アーカイブ・期限変更されたもの
+void ReminderNotifier::pruneNotified(const QDateTime &now,
+                                     const std::function<bool(const Reminder &)> &stillDue) {
+    for (auto it = notified.begin(); it != notified.end();) {
+        const Reminder reminder{it.key(), QString(), it.value()};
+        if (it.value() < now || !stillDue(reminder))
+            it = notified.erase(it);
+        else
+            ++it;
+    }
+}
+
+// 直前の通知から minimumInterval 経つまでは pending に溜めておく
+void ReminderNotifier::scheduleFlush() {
+    if (flushTimer->isActive())
+        return;
+
+    int wait = 0;
+    if (lastShown.isValid())
+        wait = qMax<qint64>(0, minimumInterval - lastShown.elapsed());
+    flushTimer->start(wait);
+}
+
+void ReminderNotifier::flush() {
+    if (pending.isEmpty())
+        return;
+
+    const int added = pending.size();
+    active.insert(pending);
+    pending.clear();
+    lastShown.start();
+
+    refreshPanel();
+    showPanel();
+
+    if (trayIcon) {
+        QString message = added == 1 && active.size() == 1
+            ? active.begin()->taskText
+            : QString("%1 件のタスクの期限が近づいています").arg(active.size());
+        trayIcon->showMessage("リマインダー", message, QSystemTrayIcon::Warning);
+    }
+
+    qDebug() << "リマインダー通知:" << added << "件追加, 表示中" << active.size() << "件";
+}
+
+void ReminderNotifier::snooze(const QList<int> &taskIds) {
+    QDateTime until = QDateTime::currentDateTime().addSecs(snoozeMinutes * 60);
+    for (int taskId : taskIds) {
+        if (!active.contains(taskId))
+            continue;
+        snoozed.insert(taskId, active.take(taskId));
+        snoozedUntil.insert(taskId, until);
+    }
+    refreshPanel();
+}
+
+// 閉じたタスクは notified に残るので再通知されない
+void ReminderNotifier::dismiss(const QList<int> &taskIds) {
+    for (int taskId : taskIds)
+        active.remove(taskId);
+    refreshPanel();
+}
+
+void ReminderNotifier::refreshPanel() {
+    if (active.isEmpty()) {
+        panel->hide();
+        return;
+    }
+
+    QList<Reminder> reminders = active.values();
+    std::sort(reminders.begin(), reminders.end(), [](const Reminder &a, const Reminder &b) {
+        return a.deadline < b.deadline;
+    });
+    panel->setReminders(reminders);
+}
+
+void ReminderNotifier::showPanel() {
+    if (active.isEmpty())
+        return;
+    panel->show();
+    panel->raise();
+}
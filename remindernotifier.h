@@ -0,0 +1,55 @@
+#ifndef REMINDERNOTIFIER_H
+#define REMINDERNOTIFIER_H
+
+#include <QObject>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSystemTrayIcon>
+#include <functional>
+#include "reminderpanel.h"
+
+// リマインダーをタスクIDで重複排除し、1回の通知にまとめて出す。
+// モーダルダイアログは使わないのでイベントループを止めない。
+class ReminderNotifier : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReminderNotifier(QWidget *window);
+
+    // タイマー1回分の期限間近タスクを渡す（同じタスク・同じ期限で通知済みなら無視される）。
+    // now は次回の走査の開始時刻。これより前の期限は二度と渡されないので通知済みの記録を捨てる。
+    // stillDue はタスクがまだ未完了で期限も変わっていないかの確認に使う
+    void post(const QList<Reminder> &due, const QDateTime &now,
+              const std::function<bool(const Reminder &)> &stillDue);
+
+public slots:
+    void snooze(const QList<int> &taskIds);
+    void dismiss(const QList<int> &taskIds);
+
+private slots:
+    void flush();
+
+private:
+    void showPanel();
+    void refreshPanel();
+    void scheduleFlush();
+    void pruneNotified(const QDateTime &now, const std::function<bool(const Reminder &)> &stillDue);
+
+    QHash<int, Reminder> pending;        // 次の通知に載せるもの
+    QHash<int, Reminder> active;         // パネルに表示中のもの
+    QHash<int, Reminder> snoozed;
+    QHash<int, QDateTime> snoozedUntil;
+    QHash<int, QDateTime> notified;      // 通知済みのタスクIDと、通知したときの期限
+
+    QTimer *flushTimer;
+    QElapsedTimer lastShown;
+    int minimumInterval = 10000;         // 通知の最小間隔（ミリ秒）
+    int snoozeMinutes = 10;
+
+    ReminderPanel *panel;
+    QSystemTrayIcon *trayIcon = nullptr;
+};
+
+#endif // REMINDERNOTIFIER_H
@@ -0,0 +1,75 @@
+#include "reminderpanel.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+namespace {
+// 一度に並べる件数の上限（それ以上は件数だけ表示する）
+const int MaxListedReminders = 200;
+}
+
+ReminderPanel::ReminderPanel(QWidget *parent)
+    : QWidget(parent, Qt::Tool)
+{
+    setWindowTitle("リマインダー");
+    setAttribute(Qt::WA_ShowWithoutActivating);  // 作業中のウィンドウからフォーカスを奪わない
+
+    summaryLabel = new QLabel(this);
+    reminderList = new QListWidget(this);
+    reminderList->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    reminderList->setUniformItemSizes(true);
+
+    snoozeButton = new QPushButton("スヌーズ (10分)", this);
+    dismissButton = new QPushButton("閉じる", this);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addStretch();
+    buttonLayout->addWidget(snoozeButton);
+    buttonLayout->addWidget(dismissButton);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(summaryLabel);
+    layout->addWidget(reminderList);
+    layout->addLayout(buttonLayout);
+
+    connect(snoozeButton, &QPushButton::clicked, this, [this]() {
+        emit snoozeRequested(targetIds());
+    });
+    connect(dismissButton, &QPushButton::clicked, this, [this]() {
+        emit dismissRequested(targetIds());
+    });
+
+    resize(420, 300);
+}
+
+void ReminderPanel::setReminders(const QList<Reminder> &reminders) {
+    allIds.clear();
+    reminderList->clear();
+
+    for (const Reminder &reminder : reminders) {
+        allIds.append(reminder.taskId);
+        if (reminderList->count() >= MaxListedReminders)
+            continue;
+
+        QListWidgetItem *item = new QListWidgetItem(
+            reminder.taskText + " (期限: " + reminder.deadline.toString("yyyy/MM/dd HH:mm") + ")",
+            reminderList);
+        item->setData(Qt::UserRole, reminder.taskId);
+    }
+
+    QString summary = QString("%1 件のタスクの期限が近づいています").arg(reminders.size());
+    if (reminders.size() > MaxListedReminders) {
+        summary += QString("（先頭 %1 件を表示）").arg(MaxListedReminders);
+    }
+    summaryLabel->setText(summary);
+}
+
+QList<int> ReminderPanel::targetIds() const {
+    const QList<QListWidgetItem *> selected = reminderList->selectedItems();
+    if (selected.isEmpty())
+        return allIds;
+
+    QList<int> ids;
+    for (QListWidgetItem *item : selected)
+        ids.append(item->data(Qt::UserRole).toInt());
+    return ids;
+}
@@ -0,0 +1,41 @@
+#ifndef REMINDERPANEL_H
+#define REMINDERPANEL_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QListWidget>
+#include <QPushButton>
+#include <QDateTime>
+#include <QList>
+
+struct Reminder {
+    int taskId;
+    QString taskText;
+    QDateTime deadline;
+};
+
+// 期限が近いタスクをまとめて表示する非モーダルのパネル
+class ReminderPanel : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ReminderPanel(QWidget *parent = nullptr);
+
+    void setReminders(const QList<Reminder> &reminders);
+
+signals:
+    void snoozeRequested(const QList<int> &taskIds);
+    void dismissRequested(const QList<int> &taskIds);
+
+private:
+    QList<int> targetIds() const;  // 選択中のタスク（未選択なら全件）
+
+    QLabel *summaryLabel;
+    QListWidget *reminderList;
+    QPushButton *snoozeButton;
+    QPushButton *dismissButton;
+    QList<int> allIds;
+};
+
+#endif // REMINDERPANEL_H
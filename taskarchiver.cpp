@@ -0,0 +1,145 @@
+#include "taskarchiver.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDateTime>
+#include <QTimer>
+#include <QDebug>
+
+TaskArchiver::TaskArchiver(QObject *parent)
+    : QObject(parent)
+{
+}
+
+bool TaskArchiver::attachArchive(const QString &fileName) {
+    if (!QSqlDatabase::database().isOpen()) {
+        qDebug() << "Database is not open!";
+        return false;
+    }
+
+    QSqlQuery query;
+    query.prepare("ATTACH DATABASE :file AS archive");
+    query.bindValue(":file", fileName);
+    if (!query.exec()) {
+        qDebug() << "アーカイブDBの接続に失敗しました:" << query.lastError().text();
+        return false;
+    }
+
+    if (!query.exec("CREATE TABLE IF NOT EXISTS archive.tasks_archive ("
+                    "id INTEGER PRIMARY KEY, "
+                    "taskText TEXT, "
+                    "deadline TEXT, "
+                    "tagText TEXT, "
+                    "completed_at TEXT, "
+                    "archived_at TEXT)")) {
+        qDebug() << "アーカイブテーブルの作成に失敗しました:" << query.lastError().text();
+        return false;
+    }
+
+    attached = true;
+    return true;
+}
+
+void TaskArchiver::start() {
+    if (running || !attached)
+        return;
+
+    running = true;
+    archivedCount = 0;
+    cutoff = QDateTime::currentDateTime().addDays(-archiveAfterDays).toString("yyyy-MM-dd HH:mm:ss");
+    QTimer::singleShot(0, this, &TaskArchiver::archiveBatch);
+}
+
+// completed_at は起動時に補完済み（MainWindow::initializeDatabase）なので NULL は考えない
+// id の小さい順に batchSize 件ずつ、コピーと削除を1トランザクションで行う
+void TaskArchiver::archiveBatch() {
+    QSqlDatabase db = QSqlDatabase::database();
+
+    QSqlQuery query;
+    query.prepare("SELECT MAX(id) FROM ("
+                  "SELECT id FROM tasks WHERE is_completed = 1 AND completed_at < :cutoff "
+                  "ORDER BY id LIMIT :batch)");
+    query.bindValue(":cutoff", cutoff);
+    query.bindValue(":batch", batchSize);
+    if (!query.exec() || !query.next() || query.value(0).isNull()) {
+        finishArchiving();
+        return;
+    }
+    const int maxId = query.value(0).toInt();
+    query.finish();
+
+    db.transaction();
+
+    query.prepare("INSERT OR REPLACE INTO archive.tasks_archive "
+                  "(id, taskText, deadline, tagText, completed_at, archived_at) "
+                  "SELECT id, taskText, deadline, tagText, completed_at, :now FROM tasks "
+                  "WHERE is_completed = 1 AND completed_at < :cutoff AND id <= :maxId");
+    query.bindValue(":now", QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+    query.bindValue(":cutoff", cutoff);
+    query.bindValue(":maxId", maxId);
+    if (!query.exec()) {
+        qDebug() << "アーカイブへのコピーに失敗しました:" << query.lastError().text();
+        db.rollback();
+        finishArchiving();
+        return;
+    }
+    const int moved = query.numRowsAffected();
+
+    query.prepare("DELETE FROM tasks WHERE is_completed = 1 AND completed_at < :cutoff AND id <= :maxId");
+    query.bindValue(":cutoff", cutoff);
+    query.bindValue(":maxId", maxId);
+    if (!query.exec() || !db.commit()) {
+        qDebug() << "アーカイブ済みタスクの削除に失敗しました:" << query.lastError().text();
+        db.rollback();
+        finishArchiving();
+        return;
+    }
+
+    archivedCount += moved;
+    QTimer::singleShot(0, this, &TaskArchiver::archiveBatch);
+}
+
+void TaskArchiver::finishArchiving() {
+    running = false;
+    qDebug() << "アーカイブ完了:" << archivedCount << "件";
+
+    if (archivedCount > 0) {
+        QTimer::singleShot(0, this, &TaskArchiver::compact);
+    }
+    emit finished(archivedCount);
+}
+
+// 既存DBの INCREMENTAL への切り替えは起動時に済んでいる（MainWindow::initializeDatabase）
+void TaskArchiver::compact() {
+    lastFreePages = -1;
+    vacuumStep();
+}
+
+// 空きページを少しずつ返してファイルを縮める（auto_vacuum = INCREMENTAL 前提）
+void TaskArchiver::vacuumStep() {
+    QSqlQuery query;
+    if (!query.exec("PRAGMA freelist_count") || !query.next()) {
+        return;
+    }
+    // 空きページが減らなくなったら終了（auto_vacuum が無効なDBでも止まるように）
+    const int freePages = query.value(0).toInt();
+    if (freePages == 0 || freePages == lastFreePages) {
+        qDebug() << "incremental_vacuum 完了: 残り空きページ" << freePages;
+        return;
+    }
+    lastFreePages = freePages;
+    query.finish();
+
+    // incremental_vacuum はステップ1回につき1ページしか返さず、QSqlQuery::exec() は
+    // 1回しかステップしないので、1ページずつ vacuumPagesPerStep 回実行する
+    query.prepare("PRAGMA incremental_vacuum(1)");
+    for (int page = 0; page < qMin(vacuumPagesPerStep, freePages); ++page) {
+        if (!query.exec()) {
+            qDebug() << "incremental_vacuum に失敗しました:" << query.lastError().text();
+            return;
+        }
+        query.finish();
+    }
+
+    QTimer::singleShot(0, this, &TaskArchiver::vacuumStep);
+}
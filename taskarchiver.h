@@ -0,0 +1,44 @@
+#ifndef TASKARCHIVER_H
+#define TASKARCHIVER_H
+
+#include <QObject>
+#include <QString>
+
+// 完了から一定日数が経ったタスクを別ファイルのアーカイブDBへ移す。
+// 小さなバッチに分けてイベントループの合間に処理し、UIを止めない。
+class TaskArchiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit TaskArchiver(QObject *parent = nullptr);
+
+    // メイン接続にアーカイブDBを ATTACH し、テーブルを用意する
+    bool attachArchive(const QString &fileName = "tasks_archive.db");
+
+public slots:
+    void start();
+
+signals:
+    void finished(int archivedCount);
+
+private slots:
+    void archiveBatch();
+    void compact();
+    void vacuumStep();
+
+private:
+    void finishArchiving();
+
+    int archiveAfterDays = 30;
+    int batchSize = 500;          // 1トランザクションで移す件数
+    int vacuumPagesPerStep = 256; // イベントループ1回あたりに解放するページ数
+
+    bool running = false;
+    bool attached = false;
+    int archivedCount = 0;
+    int lastFreePages = -1;
+    QString cutoff;
+};
+
+#endif // TASKARCHIVER_H
@@ -0,0 +1,84 @@
+#ifndef TASKBITMAP_H
+#define TASKBITMAP_H
+
+#include <QVector>
+#include <QtAlgorithms>
+#include <QtGlobal>
+
+// タスク番号ごとに1ビットを持つビットマップ（タグ・状態フィルタ用）
+class TaskBitmap {
+public:
+    TaskBitmap() = default;
+    explicit TaskBitmap(int size, bool value = false)
+        : bitCount(size), words((size + 63) / 64, value ? ~quint64(0) : 0)
+    {
+        clearTail();
+    }
+
+    int size() const { return bitCount; }
+    int wordCount() const { return words.size(); }
+    quint64 word(int w) const { return words[w]; }
+    void setWord(int w, quint64 value) { words[w] = value; }
+
+    bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+    void set(int i) { words[i >> 6] |= quint64(1) << (i & 63); }
+    void reset(int i) { words[i >> 6] &= ~(quint64(1) << (i & 63)); }
+
+    TaskBitmap &operator&=(const TaskBitmap &other) {
+        for (int w = 0; w < words.size(); ++w)
+            words[w] &= other.words[w];
+        return *this;
+    }
+
+    TaskBitmap &operator|=(const TaskBitmap &other) {
+        for (int w = 0; w < words.size(); ++w)
+            words[w] |= other.words[w];
+        return *this;
+    }
+
+    // this AND NOT other
+    TaskBitmap &andNot(const TaskBitmap &other) {
+        for (int w = 0; w < words.size(); ++w)
+            words[w] &= ~other.words[w];
+        return *this;
+    }
+
+    int count() const {
+        int total = 0;
+        for (quint64 w : words)
+            total += qPopulationCount(w);
+        return total;
+    }
+
+    bool isEmpty() const {
+        for (quint64 w : words) {
+            if (w)
+                return false;
+        }
+        return true;
+    }
+
+    // 立っているビットの番号を昇順に f に渡す
+    template <typename F>
+    void forEachSet(F f) const {
+        for (int w = 0; w < words.size(); ++w) {
+            quint64 bits = words[w];
+            while (bits) {
+                f((w << 6) + qCountTrailingZeroBits(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    // 最後のワードの余りビットは常に0にしておく
+    void clearTail() {
+        if (bitCount & 63)
+            words.last() &= (quint64(1) << (bitCount & 63)) - 1;
+    }
+
+    int bitCount = 0;
+    QVector<quint64> words;
+};
+
+#endif // TASKBITMAP_H
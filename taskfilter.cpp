@@ -0,0 +1,136 @@
+#include "taskfilter.h"
+
+TaskBitmap TaskFilter::evaluate(const TaskStore &store, const QDateTime &now) const {
+    const int n = store.size();
+    TaskBitmap result(n, true);
+
+    // 1. ビットマップだけで決まる条件（タグ・完了状態）
+    if (!requiredTag.isEmpty()) {
+        const TaskBitmap *bitmap = store.tagBitmap(requiredTag);
+        if (!bitmap)
+            return TaskBitmap(n);
+        result &= *bitmap;
+    }
+
+    if (!tags.isEmpty())
+        result &= tagMask(store);
+
+    // 期限切れのみは未完了が前提。状態の指定とは独立に AND する
+    if (status == OpenOnly || overdueOnly)
+        result.andNot(store.completed);
+    if (status == CompletedOnly)
+        result &= store.completed;
+
+    // 2. 期限列の範囲走査
+    if (overdueOnly)
+        result &= deadlineMask(store, std::numeric_limits<qint64>::min(), now.toMSecsSinceEpoch() - 1);
+
+    if (deadlineFrom.isValid() || deadlineTo.isValid()) {
+        qint64 from = deadlineFrom.isValid() ? deadlineFrom.toMSecsSinceEpoch()
+                                             : std::numeric_limits<qint64>::min();
+        qint64 to = deadlineTo.isValid() ? deadlineTo.toMSecsSinceEpoch()
+                                         : TaskStore::NoDeadline - 1;
+        result &= deadlineMask(store, from, to);
+    }
+
+    // 3. 文字列比較は最も重いので、残った候補にだけ行う
+    const QString needle = text.trimmed();
+    if (!needle.isEmpty() && !result.isEmpty()) {
+        TaskBitmap textMatches(n);
+        result.forEachSet([&](int i) {
+            if (store.names[i].contains(needle, Qt::CaseInsensitive))
+                textMatches.set(i);
+        });
+        result = textMatches;
+    }
+
+    return result;
+}
+
+bool TaskFilter::matches(const TaskStore &store, int i, const QDateTime &now) const {
+    if (!requiredTag.isEmpty()) {
+        const TaskBitmap *bitmap = store.tagBitmap(requiredTag);
+        if (!bitmap || !bitmap->test(i))
+            return false;
+    }
+
+    if (!tags.isEmpty()) {
+        bool any = false;
+        for (const QString &tag : tags) {
+            const TaskBitmap *bitmap = store.tagBitmap(tag);
+            const bool hit = bitmap && bitmap->test(i);
+            if (tagMatch == MatchAllTags && !hit)
+                return false;
+            any = any || hit;
+        }
+        if (!any)
+            return false;
+    }
+
+    const bool completed = store.isCompleted(i);
+    if ((status == OpenOnly || overdueOnly) && completed)
+        return false;
+    if (status == CompletedOnly && !completed)
+        return false;
+
+    const qint64 deadline = store.deadlines[i];
+    if (overdueOnly && deadline >= now.toMSecsSinceEpoch())
+        return false;
+    if (deadlineFrom.isValid() && deadline < deadlineFrom.toMSecsSinceEpoch())
+        return false;
+    if (deadlineTo.isValid() && deadline > deadlineTo.toMSecsSinceEpoch())
+        return false;
+    if ((deadlineFrom.isValid() || deadlineTo.isValid()) && deadline == TaskStore::NoDeadline)
+        return false;
+
+    const QString needle = text.trimmed();
+    return needle.isEmpty() || store.names[i].contains(needle, Qt::CaseInsensitive);
+}
+
+QVector<int> TaskFilter::collect(const TaskStore &store, const TaskBitmap &matches,
+                                 TaskStore::SortKey sortKey) {
+    QVector<int> rows;
+    rows.reserve(matches.count());
+    for (int i : store.order(sortKey)) {
+        if (matches.test(i))
+            rows.append(i);
+    }
+    return rows;
+}
+
+// いずれか: 各タグのビットマップの OR、すべて: AND
+TaskBitmap TaskFilter::tagMask(const TaskStore &store) const {
+    const int n = store.size();
+    TaskBitmap mask(n, tagMatch == MatchAllTags);
+
+    for (const QString &tag : tags) {
+        const TaskBitmap *bitmap = store.tagBitmap(tag);
+        if (tagMatch == MatchAllTags) {
+            if (!bitmap)
+                return TaskBitmap(n);  // 存在しないタグを要求されたら一致なし
+            mask &= *bitmap;
+        } else if (bitmap) {
+            mask |= *bitmap;
+        }
+    }
+    return mask;
+}
+
+// from <= deadline <= to を64件ずつ分岐なしで判定してワードに詰める
+TaskBitmap TaskFilter::deadlineMask(const TaskStore &store, qint64 from, qint64 to) {
+    const int n = store.size();
+    const qint64 *deadlines = store.deadlines.constData();
+    TaskBitmap mask(n);
+
+    for (int w = 0; w < mask.wordCount(); ++w) {
+        const int base = w << 6;
+        const int end = qMin(base + 64, n);
+        quint64 bits = 0;
+        for (int i = base; i < end; ++i) {
+            const qint64 d = deadlines[i];
+            bits |= quint64((d >= from) & (d <= to)) << (i - base);
+        }
+        mask.setWord(w, bits);
+    }
+    return mask;
+}
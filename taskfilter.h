@@ -0,0 +1,40 @@
+#ifndef TASKFILTER_H
+#define TASKFILTER_H
+
+#include <QDateTime>
+#include <QString>
+#include <QStringList>
+#include "taskbitmap.h"
+#include "taskstore.h"
+
+// 複合フィルタ条件。各条件をビットマップに変換して AND で合成する。
+class TaskFilter {
+public:
+    enum Status { AnyStatus, OpenOnly, CompletedOnly };
+    enum TagMatch { MatchAnyTag, MatchAllTags };
+
+    QString requiredTag;           // 空でなければこのタグを必ず含む（tags とは AND）
+    QStringList tags;              // 空なら絞り込まない
+    TagMatch tagMatch = MatchAnyTag;
+    Status status = AnyStatus;
+    bool overdueOnly = false;      // 未完了かつ期限切れ
+    QDateTime deadlineFrom;        // 無効値なら下限なし
+    QDateTime deadlineTo;          // 無効値なら上限なし
+    QString text;                  // タスク名の部分一致（大文字小文字を区別しない）
+
+    // 条件に一致するタスク番号のビットマップを返す
+    TaskBitmap evaluate(const TaskStore &store, const QDateTime &now) const;
+
+    // 1件だけ判定する（evaluate と同じ条件。少数の行を追加するとき用）
+    bool matches(const TaskStore &store, int i, const QDateTime &now) const;
+
+    // 一致したタスク番号を store の並び順で返す
+    static QVector<int> collect(const TaskStore &store, const TaskBitmap &matches,
+                               TaskStore::SortKey sortKey);
+
+private:
+    TaskBitmap tagMask(const TaskStore &store) const;
+    static TaskBitmap deadlineMask(const TaskStore &store, qint64 from, qint64 to);
+};
+
+#endif // TASKFILTER_H
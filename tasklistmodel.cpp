@@ -0,0 +1,172 @@
+#include "tasklistmodel.h"
+#include <QBrush>
+#include <QColor>
+#include <QFont>
+#include <algorithm>
+
+namespace {
+// QTimer に渡せる待ち時間の上限。これより先の期限は途中で一度起きて測り直す
+const qint64 MaxCrossingWait = 60 * 60 * 1000;
+}
+
+TaskListModel::TaskListModel(const TaskStore *store, QObject *parent)
+    : QAbstractListModel(parent), store(store), crossingTimer(new QTimer(this))
+{
+    crossingTimer->setSingleShot(true);
+    crossingTimer->setTimerType(Qt::PreciseTimer);
+    connect(crossingTimer, &QTimer::timeout, this, &TaskListModel::advanceReferenceTime);
+}
+
+int TaskListModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rows.size();
+}
+
+QVariant TaskListModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rows.size())
+        return QVariant();
+
+    const int i = rows[index.row()];
+    const bool completed = store->isCompleted(i);
+
+    switch (role) {
+    case Qt::DisplayRole: {
+        QDateTime deadline = store->deadlineAt(i);
+        QString deadlineStr = deadline.isValid() ? deadline.toString("yyyy-MM-dd HH:mm") : "なし";
+        return store->names[i] + " (" + store->tagTexts[i] + ") 期限: " + deadlineStr;
+    }
+    case Qt::ForegroundRole:
+        // 完了済みは灰色、期限切れは赤
+        if (completed)
+            return QBrush(Qt::gray);
+        if (isOverdue(i))
+            return QBrush(Qt::red);
+        return QVariant();
+    case Qt::FontRole: {
+        if (!completed && !isOverdue(i))
+            return QVariant();
+        QFont font;
+        font.setStrikeOut(completed);
+        font.setBold(!completed);
+        return font;
+    }
+    case TaskIdRole:
+        return store->ids[i];
+    case CompletedRole:
+        return completed;
+    case OverdueRole:
+        return isOverdue(i);
+    default:
+        return QVariant();
+    }
+}
+
+void TaskListModel::setRows(const QVector<int> &newRows, const QDateTime &now) {
+    beginResetModel();
+    rows = newRows;
+    referenceTime = now.toMSecsSinceEpoch();
+    rebuildRowIndex();
+    endResetModel();
+
+    scheduleNextCrossing();
+}
+
+void TaskListModel::insertTasks(const QVector<int> &tasks, TaskStore::SortKey sortKey) {
+    auto less = [this, sortKey](int a, int b) {
+        return store->lessThan(sortKey, a, b);
+    };
+
+    QVector<int> added;
+    for (int i : tasks) {
+        if (rowOfTask[i] < 0)
+            added.append(i);
+    }
+    std::sort(added.begin(), added.end(), less);
+    added.erase(std::unique(added.begin(), added.end()), added.end());
+
+    // 同じ位置に入る連続したタスクは1回の beginInsertRows でまとめて入れる
+    for (int first = 0; first < added.size();) {
+        const int row = int(std::lower_bound(rows.begin(), rows.end(), added[first], less) - rows.begin());
+        int last = first + 1;
+        while (last < added.size() && (row == rows.size() || less(added[last], rows[row])))
+            ++last;
+
+        beginInsertRows(QModelIndex(), row, row + (last - first) - 1);
+        rows.insert(row, last - first, 0);
+        std::copy(added.begin() + first, added.begin() + last, rows.begin() + row);
+        endInsertRows();
+
+        first = last;
+    }
+
+    // 挿入位置より後ろの行番号がずれるので、最後にまとめて作り直す
+    if (!added.isEmpty())
+        rebuildRowIndex();
+}
+
+void TaskListModel::rebuildRowIndex() {
+    rowOfTask.fill(-1, store->size());
+    for (int row = 0; row < rows.size(); ++row)
+        rowOfTask[rows[row]] = row;
+}
+
+// 締切順の並びから referenceTime 以降で最初に期限を迎える未完了タスクを探し、その時刻にタイマーを合わせる
+void TaskListModel::scheduleNextCrossing() {
+    const QVector<int> &byDeadline = store->order(TaskStore::SortByDeadline);
+    auto it = std::lower_bound(byDeadline.begin(), byDeadline.end(), referenceTime, [this](int i, qint64 value) {
+        return store->deadlines[i] < value;
+    });
+    while (it != byDeadline.end() && store->isCompleted(*it))
+        ++it;
+
+    if (it == byDeadline.end() || store->deadlines[*it] == TaskStore::NoDeadline) {
+        crossingTimer->stop();
+        return;
+    }
+
+    // deadline < referenceTime で期限切れなので、期限の1ms後に起きる
+    qint64 wait = store->deadlines[*it] + 1 - QDateTime::currentMSecsSinceEpoch();
+    crossingTimer->start(int(qBound<qint64>(0, wait, MaxCrossingWait)));
+}
+
+// 前回の基準時刻から今までに期限を迎えた行だけを更新する（行の作り直しはしない）
+void TaskListModel::advanceReferenceTime() {
+    const qint64 previous = referenceTime;
+    referenceTime = QDateTime::currentMSecsSinceEpoch();
+
+    const QVector<int> &byDeadline = store->order(TaskStore::SortByDeadline);
+    auto it = std::lower_bound(byDeadline.begin(), byDeadline.end(), previous, [this](int i, qint64 value) {
+        return store->deadlines[i] < value;
+    });
+
+    QVector<int> changedRows;
+    QVector<int> hiddenTasks;
+    for (; it != byDeadline.end() && store->deadlines[*it] < referenceTime; ++it) {
+        if (store->isCompleted(*it))
+            continue;
+        const int row = rowOfTask[*it];
+        if (row >= 0)
+            changedRows.append(row);
+        else
+            hiddenTasks.append(*it);
+    }
+
+    // 連続する行はまとめて1回の dataChanged にする（スリープ復帰後などの一斉通知対策）
+    const QList<int> roles = { Qt::ForegroundRole, Qt::FontRole, OverdueRole };
+    std::sort(changedRows.begin(), changedRows.end());
+    for (int first = 0; first < changedRows.size();) {
+        int last = first;
+        while (last + 1 < changedRows.size() && changedRows[last + 1] == changedRows[last] + 1)
+            ++last;
+        emit dataChanged(index(changedRows[first]), index(changedRows[last]), roles);
+        first = last + 1;
+    }
+
+    if (!hiddenTasks.isEmpty())
+        emit hiddenTasksBecameOverdue(hiddenTasks);
+
+    scheduleNextCrossing();
+}
+
+bool TaskListModel::isOverdue(int i) const {
+    return !store->isCompleted(i) && store->deadlines[i] < referenceTime;
+}
@@ -0,0 +1,52 @@
+#ifndef TASKLISTMODEL_H
+#define TASKLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QVector>
+#include <QTimer>
+#include "taskstore.h"
+
+// フィルタ結果（TaskStore のタスク番号列）をそのまま行として見せるモデル
+class TaskListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    enum Roles {
+        TaskIdRole = Qt::UserRole + 1,
+        CompletedRole,
+        OverdueRole
+    };
+
+    explicit TaskListModel(const TaskStore *store, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // rows は TaskStore のタスク番号。now は期限切れ判定の基準時刻
+    void setRows(const QVector<int> &rows, const QDateTime &now);
+    int storeIndex(int row) const { return rows.value(row, -1); }
+
+    // 表示していないタスクを並び順の位置に挿入する（モデルのリセットはしない）
+    void insertTasks(const QVector<int> &tasks, TaskStore::SortKey sortKey);
+
+signals:
+    // 表示していない未完了タスクが期限を過ぎた（期限切れで絞り込んでいれば追加が必要）
+    void hiddenTasksBecameOverdue(const QVector<int> &tasks);
+
+private slots:
+    void advanceReferenceTime();
+
+private:
+    bool isOverdue(int i) const;
+    void scheduleNextCrossing();
+    void rebuildRowIndex();
+
+    const TaskStore *store;
+    QVector<int> rows;
+    QVector<int> rowOfTask;   // タスク番号 → 行（表示していなければ -1）
+    qint64 referenceTime = 0;
+    QTimer *crossingTimer;    // 次に期限を迎えるタスクの時刻に合わせて1回だけ動く
+};
+
+#endif // TASKLISTMODEL_H
@@ -0,0 +1,172 @@
+#include "taskstore.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <numeric>
+
+bool TaskStore::loadFromDatabase() {
+    clear();
+
+    if (!QSqlDatabase::database().isOpen()) {
+        qDebug() << "Database is not open!";
+        return false;
+    }
+
+    QSqlQuery query;
+    query.setForwardOnly(true);
+    if (!query.exec("SELECT id, taskText, deadline, tagText, is_completed FROM tasks")) {
+        qDebug() << "Failed to load tasks:" << query.lastError().text();
+        return false;
+    }
+
+    QVector<int> tagRefs;      // タスク番号ごとのタグ番号を平らに並べたもの
+    QVector<int> tagRefStart;  // tagRefs 内の開始位置
+    QVector<bool> completedFlags;
+
+    while (query.next()) {
+        ids.append(query.value(0).toInt());
+        names.append(query.value(1).toString());
+
+        QDateTime deadline = parseDeadline(query.value(2).toString());
+        deadlines.append(deadline.isValid() ? deadline.toMSecsSinceEpoch() : NoDeadline);
+
+        QString tagText = query.value(3).toString();
+        tagTexts.append(tagText);
+        tagRefStart.append(tagRefs.size());
+        for (const QString &tag : splitTags(tagText)) {
+            auto it = tagIndex.constFind(tag);
+            if (it == tagIndex.constEnd()) {
+                it = tagIndex.insert(tag, tagNames.size());
+                tagNames.append(tag);
+            }
+            tagRefs.append(it.value());
+        }
+
+        completedFlags.append(query.value(4).toBool());
+    }
+    tagRefStart.append(tagRefs.size());
+
+    // 件数が確定してからビットマップを作る
+    const int n = ids.size();
+    completed = TaskBitmap(n);
+    tagBitmaps = QVector<TaskBitmap>(tagNames.size(), TaskBitmap(n));
+    for (int i = 0; i < n; ++i) {
+        if (completedFlags[i])
+            completed.set(i);
+        for (int r = tagRefStart[i]; r < tagRefStart[i + 1]; ++r)
+            tagBitmaps[tagRefs[r]].set(i);
+    }
+
+    buildIndexes();
+
+    qDebug() << "TaskStore loaded:" << n << "tasks," << tagNames.size() << "tags";
+    return true;
+}
+
+void TaskStore::clear() {
+    ids.clear();
+    names.clear();
+    tagTexts.clear();
+    deadlines.clear();
+    completed = TaskBitmap();
+    tagNames.clear();
+    tagBitmaps.clear();
+    tagIndex.clear();
+    orderByName.clear();
+    orderByDeadline.clear();
+    orderByTag.clear();
+}
+
+QDateTime TaskStore::deadlineAt(int i) const {
+    if (deadlines[i] == NoDeadline)
+        return QDateTime();
+    return QDateTime::fromMSecsSinceEpoch(deadlines[i]);
+}
+
+const TaskBitmap *TaskStore::tagBitmap(const QString &tag) const {
+    auto it = tagIndex.constFind(tag.trimmed());
+    if (it == tagIndex.constEnd())
+        return nullptr;
+    return &tagBitmaps[it.value()];
+}
+
+const QVector<int> &TaskStore::order(SortKey key) const {
+    switch (key) {
+    case SortByName:
+        return orderByName;
+    case SortByTag:
+        return orderByTag;
+    case SortByDeadline:
+    default:
+        return orderByDeadline;
+    }
+}
+
+// 保存経路によって期限の書式が異なるため、既知の書式を順に試す
+QDateTime TaskStore::parseDeadline(const QString &text) {
+    static const char *const formats[] = {
+        "yyyy/MM/dd HH:mm",
+        "yyyy-MM-dd HH:mm:ss",
+        "yyyy-MM-dd HH:mm",
+    };
+
+    QDateTime dt = QDateTime::fromString(text, Qt::ISODate);
+    for (const char *format : formats) {
+        if (dt.isValid())
+            break;
+        dt = QDateTime::fromString(text, QString::fromLatin1(format));
+    }
+    return dt;
+}
+
+QStringList TaskStore::splitTags(const QString &tagText) {
+    QStringList tags;
+    for (const QString &part : tagText.split(',', Qt::SkipEmptyParts)) {
+        QString tag = part.trimmed();
+        if (!tag.isEmpty() && !tags.contains(tag))
+            tags.append(tag);
+    }
+    return tags;
+}
+
+bool TaskStore::lessThan(SortKey key, int a, int b) const {
+    switch (key) {
+    case SortByName:
+        if (names[a] != names[b])
+            return names[a] < names[b];
+        break;
+    case SortByTag:
+        if (tagTexts[a] != tagTexts[b])
+            return tagTexts[a] < tagTexts[b];
+        break;
+    case SortByDeadline:
+    default:
+        if (deadlines[a] != deadlines[b])
+            return deadlines[a] < deadlines[b];
+        break;
+    }
+    return a < b;
+}
+
+// 並び替えはロード時に一度だけ行い、以降は順序配列を辿るだけにする
+void TaskStore::buildIndexes() {
+    QVector<int> base(ids.size());
+    std::iota(base.begin(), base.end(), 0);
+
+    orderByName = base;
+    std::sort(orderByName.begin(), orderByName.end(), [this](int a, int b) {
+        return lessThan(SortByName, a, b);
+    });
+
+    orderByDeadline = base;
+    std::sort(orderByDeadline.begin(), orderByDeadline.end(), [this](int a, int b) {
+        return lessThan(SortByDeadline, a, b);
+    });
+
+    orderByTag = base;
+    std::sort(orderByTag.begin(), orderByTag.end(), [this](int a, int b) {
+        return lessThan(SortByTag, a, b);
+    });
+}
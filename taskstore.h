@@ -0,0 +1,56 @@
+#ifndef TASKSTORE_H
+#define TASKSTORE_H
+
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QDateTime>
+#include <limits>
+#include "taskbitmap.h"
+
+// tasks テーブルを列ごとの配列として保持する。
+// フィルタは行オブジェクトではなくこの配列とビットマップの上で評価する。
+class TaskStore {
+public:
+    enum SortKey { SortByName, SortByDeadline, SortByTag };
+
+    // 期限なし（または解釈できない期限）
+    static constexpr qint64 NoDeadline = std::numeric_limits<qint64>::max();
+
+    bool loadFromDatabase();
+    void clear();
+
+    int size() const { return ids.size(); }
+    bool isCompleted(int i) const { return completed.test(i); }
+    QDateTime deadlineAt(int i) const;
+
+    // タグ名に対応するビットマップ。未知のタグなら nullptr
+    const TaskBitmap *tagBitmap(const QString &tag) const;
+    const QVector<int> &order(SortKey key) const;
+    // order(key) の並び順（同値はタスク番号順）
+    bool lessThan(SortKey key, int a, int b) const;
+
+    static QDateTime parseDeadline(const QString &text);
+    static QStringList splitTags(const QString &tagText);
+
+    // 列データ（添字 = タスク番号）
+    QVector<int> ids;
+    QVector<QString> names;
+    QVector<QString> tagTexts;
+    QVector<qint64> deadlines;  // エポックからのミリ秒
+    TaskBitmap completed;
+
+    QStringList tagNames;
+    QVector<TaskBitmap> tagBitmaps;
+
+private:
+    void buildIndexes();
+
+    QHash<QString, int> tagIndex;
+    QVector<int> orderByName;
+    QVector<int> orderByDeadline;
+    QVector<int> orderByTag;
+};
+
+#endif // TASKSTORE_H
@@ -0,0 +1,22 @@
+# TaskFilter の evaluate（ビットマップ）と matches（1件判定）が一致するかの確認
+#   qmake && make && ./tst_taskfilter
+
+QT       += core sql testlib
+QT       -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+TARGET = tst_taskfilter
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    tst_taskfilter.cpp \
+    ../../taskstore.cpp \
+    ../../taskfilter.cpp
+
+HEADERS += \
+    ../../taskbitmap.h \
+    ../../taskfilter.h \
+    ../../taskstore.h
@@ -0,0 +1,154 @@
+#include <QtTest>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include "taskfilter.h"
+#include "taskstore.h"
+
+// evaluate はビットマップで一括判定し、matches は1件ずつ判定する。
+// 期限切れの行を後から挿入するときは matches を使うので、両者の結果がずれると
+// 一覧の内容がフィルタ条件と食い違う。条件の組み合わせを総当たりで突き合わせる。
+class TaskFilterTest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void evaluateAgreesWithMatches();
+    void overdueWithCompletedOnly();
+    void requiredTagNarrowsAnyMatch();
+
+private:
+    void expectAgreement(const TaskFilter &filter);
+
+    TaskStore store;
+    QDateTime now;
+};
+
+void TaskFilterTest::initTestCase() {
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+    db.setDatabaseName(":memory:");
+    QVERIFY(db.open());
+
+    QSqlQuery query;
+    QVERIFY(query.exec("CREATE TABLE tasks (id INTEGER PRIMARY KEY AUTOINCREMENT, taskText TEXT, "
+                       "deadline TEXT, tagText TEXT, is_completed INTEGER DEFAULT 0)"));
+
+    now = QDateTime(QDate(2024, 6, 1), QTime(12, 0));
+    const QStringList tagTexts = { "", "a", "b", "a, b", "c", "a,c", " b , c " };
+    const int offsetsHours[] = { -48, -1, 0, 1, 48 };
+
+    // タグ・完了状態・期限（過去／ちょうど今／未来／なし）を一通り組み合わせる
+    QVERIFY(QSqlDatabase::database().transaction());
+    query.prepare("INSERT INTO tasks (taskText, deadline, tagText, is_completed) "
+                  "VALUES (:taskText, :deadline, :tagText, :is_completed)");
+    int number = 0;
+    for (const QString &tagText : tagTexts) {
+        for (int completed = 0; completed < 2; ++completed) {
+            for (int d = 0; d <= 5; ++d) {
+                QString deadline;
+                if (d < 5)
+                    deadline = now.addSecs(offsetsHours[d] * 3600).toString("yyyy-MM-dd HH:mm:ss");
+                query.bindValue(":taskText", QString("Task %1").arg(number++));
+                query.bindValue(":deadline", deadline);
+                query.bindValue(":tagText", tagText);
+                query.bindValue(":is_completed", completed);
+                QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+            }
+        }
+    }
+    QVERIFY(QSqlDatabase::database().commit());
+
+    QVERIFY(store.loadFromDatabase());
+    QCOMPARE(store.size(), number);
+}
+
+void TaskFilterTest::expectAgreement(const TaskFilter &filter) {
+    const TaskBitmap result = filter.evaluate(store, now);
+    QCOMPARE(result.size(), store.size());
+    for (int i = 0; i < store.size(); ++i) {
+        if (result.test(i) != filter.matches(store, i, now)) {
+            QFAIL(qPrintable(QString("mismatch at %1: status=%2 overdue=%3 tagMatch=%4 tags=[%5] "
+                                     "requiredTag=%6 from=%7 to=%8 text=%9")
+                                 .arg(store.names[i])
+                                 .arg(int(filter.status))
+                                 .arg(int(filter.overdueOnly))
+                                 .arg(int(filter.tagMatch))
+                                 .arg(filter.tags.join(','))
+                                 .arg(filter.requiredTag)
+                                 .arg(filter.deadlineFrom.toString(Qt::ISODate))
+                                 .arg(filter.deadlineTo.toString(Qt::ISODate))
+                                 .arg(filter.text)));
+        }
+    }
+}
+
+void TaskFilterTest::evaluateAgreesWithMatches() {
+    const TaskFilter::Status statuses[] = { TaskFilter::AnyStatus, TaskFilter::OpenOnly,
+                                            TaskFilter::CompletedOnly };
+    const TaskFilter::TagMatch tagMatches[] = { TaskFilter::MatchAnyTag, TaskFilter::MatchAllTags };
+    const QList<QStringList> tagLists = { {}, { "a" }, { "a", "b" }, { "zz" }, { "a", "zz" } };
+    const QStringList requiredTags = { "", "b", "zz" };
+    const QList<QPair<QDateTime, QDateTime>> ranges = {
+        { QDateTime(), QDateTime() },
+        { now.addSecs(-3600), QDateTime() },
+        { QDateTime(), now },
+        { now.addSecs(-3600), now.addSecs(3600) },
+    };
+    const QStringList texts = { "", "task 1" };
+
+    for (TaskFilter::Status status : statuses) {
+        for (int overdue = 0; overdue < 2; ++overdue) {
+            for (TaskFilter::TagMatch tagMatch : tagMatches) {
+                for (const QStringList &tags : tagLists) {
+                    for (const QString &requiredTag : requiredTags) {
+                        for (const auto &range : ranges) {
+                            for (const QString &text : texts) {
+                                TaskFilter filter;
+                                filter.status = status;
+                                filter.overdueOnly = overdue;
+                                filter.tagMatch = tagMatch;
+                                filter.tags = tags;
+                                filter.requiredTag = requiredTag;
+                                filter.deadlineFrom = range.first;
+                                filter.deadlineTo = range.second;
+                                filter.text = text;
+                                expectAgreement(filter);
+                                if (QTest::currentTestFailed())
+                                    return;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// 期限切れのみ（未完了が前提）と完了済みのみを同時に指定したら一致なし
+void TaskFilterTest::overdueWithCompletedOnly() {
+    TaskFilter filter;
+    filter.status = TaskFilter::CompletedOnly;
+    filter.overdueOnly = true;
+    QVERIFY(filter.evaluate(store, now).isEmpty());
+}
+
+// コンボのタグは「いずれか」の指定を広げず、必ず AND で効く
+void TaskFilterTest::requiredTagNarrowsAnyMatch() {
+    TaskFilter filter;
+    filter.tagMatch = TaskFilter::MatchAnyTag;
+    filter.tags = QStringList { "a" };
+    const int withoutRequired = filter.evaluate(store, now).count();
+
+    filter.requiredTag = "c";
+    const TaskBitmap narrowed = filter.evaluate(store, now);
+    QVERIFY(narrowed.count() < withoutRequired);
+    narrowed.forEachSet([&](int i) {
+        const QStringList tags = TaskStore::splitTags(store.tagTexts[i]);
+        QVERIFY(tags.contains("a") && tags.contains("c"));
+    });
+}
+
+QTEST_GUILESS_MAIN(TaskFilterTest)
+
+#include "tst_taskfilter.moc"